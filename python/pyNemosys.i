@@ -16,6 +16,15 @@
 #include "jsoncons/json.hpp"
 #include "meshGen.H"
 #include "meshingParams.H"
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkPointData.h>
+#include <vtkPointSet.h>
+#include <vtkPoints.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkVersion.h>
 %}
 
 
@@ -37,6 +46,257 @@
 int diffMesh(meshBase *mesh1, meshBase *mesh2);
 
 
+// Raw description of a VTK array for the NumPy views below. address is 0
+// and error is set when no view can be made.
+%inline %{
+struct pyArrayView {
+  std::size_t address;
+  long long nTuples;
+  int nComponents;
+  std::string dtype;
+  std::string error;
+};
+%}
+
+%{
+// NumPy type string of a VTK data type, empty if there is none
+static std::string pyNumpyType(int vtkType) {
+  switch (vtkType) {
+    case VTK_FLOAT: return "f4";
+    case VTK_DOUBLE: return "f8";
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR: return "i1";
+    case VTK_UNSIGNED_CHAR: return "u1";
+    case VTK_SHORT: return "i2";
+    case VTK_UNSIGNED_SHORT: return "u2";
+    case VTK_INT: return "i4";
+    case VTK_UNSIGNED_INT: return "u4";
+    case VTK_LONG: return "i" + std::to_string(sizeof(long));
+    case VTK_UNSIGNED_LONG: return "u" + std::to_string(sizeof(long));
+    case VTK_LONG_LONG: return "i8";
+    case VTK_UNSIGNED_LONG_LONG: return "u8";
+    case VTK_ID_TYPE: return "i" + std::to_string(sizeof(vtkIdType));
+    default: return "";
+  }
+}
+
+static pyArrayView pyViewOf(vtkDataArray *arr, const std::string &what) {
+  pyArrayView view = {0, 0, 0, "", ""};
+  if (!arr) {
+    view.error = "no " + what + " in the mesh";
+    return view;
+  }
+  view.dtype = pyNumpyType(arr->GetDataType());
+  if (view.dtype.empty() || !arr->HasStandardMemoryLayout()) {
+    view.error = what + " is not stored as a contiguous numeric array";
+    return view;
+  }
+  view.nTuples = arr->GetNumberOfTuples();
+  view.nComponents = arr->GetNumberOfComponents();
+  view.address = reinterpret_cast<std::size_t>(arr->GetVoidPointer(0));
+  return view;
+}
+
+// wraps memory owned by Python in a double array without copying it
+static vtkSmartPointer<vtkDoubleArray> pyAdoptDoubles(std::size_t address,
+                                                      long long nTuples,
+                                                      int nComponents) {
+  vtkSmartPointer<vtkDoubleArray> arr = vtkSmartPointer<vtkDoubleArray>::New();
+  arr->SetNumberOfComponents(nComponents);
+  // save = 1: VTK never frees the buffer
+  arr->SetArray(reinterpret_cast<double *>(address),
+                static_cast<vtkIdType>(nTuples) * nComponents, 1);
+  return arr;
+}
+%}
+
+%extend meshBase {
+
+    pyArrayView py_pointsView() {
+      vtkPointSet *ps = vtkPointSet::SafeDownCast($self->getDataSet());
+      return pyViewOf(ps && ps->GetPoints() ? ps->GetPoints()->GetData()
+                                            : nullptr, "point coordinates");
+    }
+
+    // cell array as stored: count-prefixed before VTK 9, connectivity only
+    // from VTK 9 on
+    pyArrayView py_cellsView() {
+      vtkUnstructuredGrid *ug =
+          vtkUnstructuredGrid::SafeDownCast($self->getDataSet());
+      if (!ug || !ug->GetCells())
+        return pyViewOf(nullptr, "unstructured cell array");
+#if VTK_MAJOR_VERSION >= 9
+      return pyViewOf(ug->GetCells()->GetConnectivityArray(), "connectivity");
+#else
+      return pyViewOf(ug->GetCells()->GetData(), "connectivity");
+#endif
+    }
+
+    // cell offsets into py_cellsView, one per cell before VTK 9 and one more
+    // from VTK 9 on
+    pyArrayView py_cellOffsetsView() {
+      vtkUnstructuredGrid *ug =
+          vtkUnstructuredGrid::SafeDownCast($self->getDataSet());
+      if (!ug || !ug->GetCells())
+        return pyViewOf(nullptr, "unstructured cell array");
+#if VTK_MAJOR_VERSION >= 9
+      return pyViewOf(ug->GetCells()->GetOffsetsArray(), "cell offsets");
+#else
+      return pyViewOf(ug->GetCellLocationsArray(), "cell offsets");
+#endif
+    }
+
+    pyArrayView py_pointDataView(const std::string &name) {
+      return pyViewOf($self->getDataSet()->GetPointData()->GetArray(
+          name.c_str()), "point data " + name);
+    }
+
+    pyArrayView py_cellDataView(const std::string &name) {
+      return pyViewOf($self->getDataSet()->GetCellData()->GetArray(
+          name.c_str()), "cell data " + name);
+    }
+
+    // tell VTK the arrays were changed through a writable view
+    void py_modified() {
+      vtkDataSet *ds = $self->getDataSet();
+      vtkPointSet *ps = vtkPointSet::SafeDownCast(ds);
+      if (ps && ps->GetPoints())
+        ps->GetPoints()->Modified();
+      vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(ds);
+      if (ug && ug->GetCells())
+        ug->GetCells()->Modified();
+      ds->Modified();
+    }
+
+    bool py_adoptPoints(std::size_t address, long long nPoints) {
+      vtkPointSet *ps = vtkPointSet::SafeDownCast($self->getDataSet());
+      if (!ps || nPoints != static_cast<long long>($self->getNumberOfPoints()))
+        return false;
+      vtkSmartPointer<vtkPoints> pnts = vtkSmartPointer<vtkPoints>::New();
+      pnts->SetData(pyAdoptDoubles(address, nPoints, 3));
+      ps->SetPoints(pnts);
+      return true;
+    }
+
+    bool py_adoptPointData(const std::string &name, std::size_t address,
+                           long long nTuples, int nComponents) {
+      if (nTuples != static_cast<long long>($self->getNumberOfPoints()))
+        return false;
+      vtkSmartPointer<vtkDoubleArray> arr =
+          pyAdoptDoubles(address, nTuples, nComponents);
+      arr->SetName(name.c_str());
+      $self->getDataSet()->GetPointData()->AddArray(arr);
+      return true;
+    }
+
+    bool py_adoptCellData(const std::string &name, std::size_t address,
+                          long long nTuples, int nComponents) {
+      if (nTuples != static_cast<long long>($self->getNumberOfCells()))
+        return false;
+      vtkSmartPointer<vtkDoubleArray> arr =
+          pyAdoptDoubles(address, nTuples, nComponents);
+      arr->SetName(name.c_str());
+      $self->getDataSet()->GetCellData()->AddArray(arr);
+      return true;
+    }
+
+    %pythoncode %{
+
+    def _numpyView(self, view, writable):
+        import ctypes
+        import numpy
+        if view.error:
+            raise ValueError(view.error)
+        dtype = numpy.dtype(view.dtype)
+        nItems = view.nTuples * view.nComponents
+        if nItems == 0:
+            # an empty VTK array may have no buffer at all
+            arr = numpy.empty(0, dtype=dtype)
+        else:
+            buf = (ctypes.c_char * (nItems * dtype.itemsize)).from_address(
+                view.address)
+            # the buffer, and through it the view, keeps the mesh alive
+            buf._nemOwner = self
+            arr = numpy.frombuffer(buf, dtype=dtype)
+        if view.nComponents > 1:
+            arr = arr.reshape(view.nTuples, view.nComponents)
+        arr.flags.writeable = writable
+        return arr
+
+    def getPointsView(self, writable=False):
+        """Point coordinates as a (nPoints, 3) array sharing VTK's memory.
+        Call modified() after writing through a writable view."""
+        return self._numpyView(self.py_pointsView(), writable)
+
+    def getCellsView(self, writable=False):
+        """Unstructured cell array sharing VTK's memory, in the layout of the
+        VTK build: (n, id0, ..., idn-1) per cell before VTK 9, the point ids
+        alone from VTK 9 on."""
+        return self._numpyView(self.py_cellsView(), writable)
+
+    def getCellOffsetsView(self, writable=False):
+        """Offsets of the cells into getCellsView()."""
+        return self._numpyView(self.py_cellOffsetsView(), writable)
+
+    def getPointDataView(self, name, writable=False):
+        """Point data array sharing VTK's memory, (nPoints,) or
+        (nPoints, nComponents)."""
+        return self._numpyView(self.py_pointDataView(name), writable)
+
+    def getCellDataView(self, name, writable=False):
+        """Cell data array sharing VTK's memory, (nCells,) or
+        (nCells, nComponents)."""
+        return self._numpyView(self.py_cellDataView(name), writable)
+
+    def modified(self):
+        """Mark points, cells and the data set modified after writes."""
+        self.py_modified()
+
+    def _adoptable(self, data, nComponents=None):
+        import numpy
+        # no copy for C-contiguous float64 input
+        arr = numpy.ascontiguousarray(data, dtype=numpy.float64)
+        if nComponents is not None:
+            arr = arr.reshape(-1, nComponents)
+        elif arr.ndim == 1:
+            arr = arr.reshape(-1, 1)
+        if arr.ndim != 2:
+            raise ValueError('expected a 1D or 2D array')
+        # VTK uses the buffer in place, so the mesh holds on to it
+        if '_nemAdopted' not in self.__dict__:
+            self.__dict__['_nemAdopted'] = {}
+        return arr
+
+    def adoptPoints(self, data):
+        """Use a (nPoints, 3) float64 array as the point coordinates without
+        copying it. The point count must not change."""
+        arr = self._adoptable(data, 3)
+        if not self.py_adoptPoints(arr.ctypes.data, arr.shape[0]):
+            raise ValueError('point count does not match the mesh')
+        self.__dict__['_nemAdopted'][('points', '')] = arr
+
+    def adoptPointData(self, name, data):
+        """Use a (nPoints,) or (nPoints, nComponents) float64 array as point
+        data without copying it."""
+        arr = self._adoptable(data)
+        if not self.py_adoptPointData(name, arr.ctypes.data, arr.shape[0],
+                                      arr.shape[1]):
+            raise ValueError('array length does not match the point count')
+        self.__dict__['_nemAdopted'][('point', name)] = arr
+
+    def adoptCellData(self, name, data):
+        """Use a (nCells,) or (nCells, nComponents) float64 array as cell
+        data without copying it."""
+        arr = self._adoptable(data)
+        if not self.py_adoptCellData(name, arr.ctypes.data, arr.shape[0],
+                                     arr.shape[1]):
+            raise ValueError('array length does not match the cell count')
+        self.__dict__['_nemAdopted'][('cell', name)] = arr
+
+    %}
+};
+
+
 %include "NemDriver.H"
 
 %extend NemDriver {
@@ -44,7 +44,6 @@ class meshBase
     virtual void unsetFieldDataArray(const char* name);
     virtual std::vector<double> getCellLengths();
     virtual std::vector<double> getCellCenter(int cellID);
-    vtkSmartPointer<vtkCellLocator> buildLocator();
     virtual void getIntegrationPointsAtCell(int cellID);int transfer(meshBase* target, std::string method,
                  const std::vector<int>& arrayIDs);
     int transfer(meshBase* target, std::string method,
@@ -65,7 +64,7 @@ class meshBase
     virtual void report();
     int getNumberOfPoints();
     int getNumberOfCells();
-    void checkMesh(std::string ofname);
+    void checkMesh(std::string ofname, bool writeCellQuality = false);
 
     virtual void write();
     virtual void write(std::string fname);
@@ -254,7 +253,8 @@ class MeshQualityDriver : public NemDriver
 {
   public:
 
-    MeshQualityDriver(std::string _mesh, std::string ofname);
+    MeshQualityDriver(std::string _mesh, std::string ofname,
+                      bool writeCellQuality = false);
     ~MeshQualityDriver();
 
     static MeshQualityDriver* readJSON(json inputjson);
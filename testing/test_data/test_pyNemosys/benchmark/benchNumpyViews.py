@@ -0,0 +1,59 @@
+"""Times copying mesh arrays through the STL vector wrappers against the
+NumPy views of pyNemosys.
+
+Usage: python benchNumpyViews.py [mesh file] [array name]
+
+The mesh defaults to ../transfer/case0001.vtu. Point coordinates are always
+timed; the named point data array is timed if the mesh has it.
+"""
+from __future__ import print_function
+
+import os
+import sys
+import time
+
+import numpy
+from pyNemosys import meshBase, doubleV
+
+
+def timed(label, func):
+    t0 = time.time()
+    ret = func()
+    print('  {:<34s}{:10.3f} s'.format(label, time.time() - t0))
+    return ret
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    fname = (sys.argv[1] if len(sys.argv) > 1 else
+             os.path.join(here, '..', 'transfer', 'case0001.vtu'))
+    arrName = sys.argv[2] if len(sys.argv) > 2 else None
+
+    mesh = meshBase.Create(fname)
+    nPnt = mesh.getNumberOfPoints()
+    print('{}: {} points, {} cells'.format(fname, nPnt,
+                                           mesh.getNumberOfCells()))
+
+    print('point coordinates')
+    crd = timed('getPoint per point',
+                lambda: numpy.array([mesh.getPoint(i) for i in range(nPnt)]))
+    view = timed('getPointsView', lambda: mesh.getPointsView())
+    copy = timed('getPointsView + copy', lambda: mesh.getPointsView().copy())
+    assert numpy.array_equal(crd, view) and numpy.array_equal(crd, copy)
+
+    if arrName:
+        print('point data ' + arrName)
+        vec = doubleV()
+        timed('getPointDataArray',
+              lambda: mesh.getPointDataArray(arrName, vec))
+        timed('getPointDataView', lambda: mesh.getPointDataView(arrName))
+
+    print('setting point data')
+    data = numpy.random.rand(nPnt)
+    timed('setPointDataArray',
+          lambda: mesh.setPointDataArray('benchSet', doubleV(data.tolist())))
+    timed('adoptPointData', lambda: mesh.adoptPointData('benchAdopt', data))
+
+
+if __name__ == '__main__':
+    main()
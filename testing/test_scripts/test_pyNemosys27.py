@@ -48,6 +48,87 @@ class TestPyNemosys(unittest.TestCase):
         self.assertEqual(diffMesh(meshBase.Create(gold_output_file), meshBase.Create(output_file)), 0)
         self.assertEqual(diffMesh(meshBase.Create(gold_output_file), target), 0)
 
+    def testMeshBaseNumpyViews(self):
+        frameinfo = getframeinfo(currentframe())
+        print (str(frameinfo.filename) + '-' + str(frameinfo.lineno))
+        try:
+            import numpy
+        except ImportError:
+            self.skipTest('numpy is not available')
+        from pyNemosys import meshBase
+
+        path = topsrcdir + '/test_data/test_pyNemosys/transfer/'
+        os.chdir(path)
+        mesh = meshBase.Create('case0001.vtu')
+        nPnt = mesh.getNumberOfPoints()
+
+        # views share memory with the mesh
+        pnts = mesh.getPointsView()
+        self.assertEqual(pnts.shape, (nPnt, 3))
+        self.assertFalse(pnts.flags.writeable)
+        for i in [0, nPnt // 2, nPnt - 1]:
+            self.assertEqual(list(pnts[i]), list(mesh.getPoint(i)))
+        # writes go straight into VTK's memory
+        x0 = mesh.getPoint(0)[0]
+        wPnts = mesh.getPointsView(writable=True)
+        wPnts[0, 0] += 1.0
+        mesh.modified()
+        self.assertEqual(mesh.getPoint(0)[0], x0 + 1.0)
+        self.assertEqual(pnts[0, 0], x0 + 1.0)
+        wPnts[0, 0] = x0
+        mesh.modified()
+
+        # cell connectivity in the layout of the VTK build
+        nCell = mesh.getNumberOfCells()
+        cells = mesh.getCellsView()
+        offsets = mesh.getCellOffsetsView()
+        self.assertIn(len(offsets), [nCell, nCell + 1])
+        for i in [0, nCell // 2, nCell - 1]:
+            if len(offsets) == nCell + 1:
+                ids = cells[offsets[i]:offsets[i + 1]]
+            else:
+                ids = cells[offsets[i] + 1:offsets[i] + 1 + cells[offsets[i]]]
+            self.assertEqual([list(pnts[j]) for j in ids],
+                             [list(x) for x in mesh.getCellVec(i)])
+
+        # adopted arrays are used in place
+        data = numpy.arange(nPnt, dtype=numpy.float64)
+        mesh.adoptPointData('viewTest', data)
+        view = mesh.getPointDataView('viewTest')
+        data[1] = -1.0
+        self.assertEqual(view[1], -1.0)
+        self.assertRaises(ValueError, mesh.adoptPointData, 'short', data[1:])
+
+        cellData = numpy.arange(2 * nCell, dtype=numpy.float64).reshape(nCell, 2)
+        mesh.adoptCellData('cellViewTest', cellData)
+        cellView = mesh.getCellDataView('cellViewTest')
+        self.assertEqual(cellView.shape, (nCell, 2))
+        self.assertTrue(numpy.array_equal(cellView, cellData))
+        cellData[3, 1] = -5.0
+        self.assertEqual(cellView[3, 1], -5.0)
+        self.assertRaises(ValueError, mesh.adoptCellData, 'short', cellData[1:])
+
+        newPnts = numpy.array(pnts)
+        newPnts[:, 2] += 2.0
+        mesh.adoptPoints(newPnts)
+        self.assertEqual(mesh.getPoint(1)[2], newPnts[1, 2])
+        newPnts[1, 2] = 7.0
+        mesh.modified()
+        self.assertEqual(mesh.getPoint(1)[2], 7.0)
+        self.assertRaises(ValueError, mesh.adoptPoints, newPnts[1:])
+
+        # missing arrays name themselves, empty ones give empty views
+        self.assertRaisesRegexp(ValueError, 'noSuchArray',
+                                mesh.getPointDataView, 'noSuchArray')
+        class emptyView(object):
+            address = 0
+            error = ''
+            dtype = 'float64'
+            nTuples = 0
+            nComponents = 3
+        empty = mesh._numpyView(emptyView(), False)
+        self.assertEqual(empty.shape, (0, 3))
+
     def testTransferDriver(self):
         frameinfo = getframeinfo(currentframe())
         print (str(frameinfo.filename) + '-' + str(frameinfo.lineno))